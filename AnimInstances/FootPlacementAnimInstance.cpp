@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FootPlacementAnimInstance.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+UFootPlacementAnimInstance::UFootPlacementAnimInstance()
+	:
+	IKFootPlacementInterpSpeed(22.5f),
+	IKFootPlacementSolveRate(0.0f),
+	IKFootPlacementPelvises({}),
+	PelvisOutputs({}),
+	IkAlpha(1.0f),
+	PelvisSolvers({}),
+	PelvisFixedFeetDataIndices({}),
+	BipedPelvisFeetData({}),
+	QuadrupedPelvisFeetData({}),
+	World(nullptr),
+	FootPlacementCharacter(nullptr),
+	MeshComponent(nullptr),
+	CapsuleComponent(nullptr),
+	CharacterCapsuleCenterWorldLocation(FVector::ZeroVector),
+	CharacterCapsuleHalfHeight(0.0f)
+{
+}
+
+void UFootPlacementAnimInstance::SetFootPlacementFlag(const int32 PelvisIndex, const int32 FootIndex, const bool bPlaceFoot)
+{
+	// Indices come from notify states authored in animation assets, so they are validated in all builds. Every solver has the same number of feet as the pelvis' foot
+	// parameters
+	if (!PelvisSolvers.IsValidIndex(PelvisIndex) || !IKFootPlacementPelvises[PelvisIndex].IKFootPlacementFootParams.IsValidIndex(FootIndex))
+	{
+		return;
+	}
+
+	switch (PelvisSolvers[PelvisIndex])
+	{
+	case EFootPlacementPelvisSolver::Biped:
+		BipedPelvisFeetData[PelvisFixedFeetDataIndices[PelvisIndex]].FootPlacementFlags[FootIndex] = bPlaceFoot;
+		break;
+
+	case EFootPlacementPelvisSolver::Quadruped:
+		QuadrupedPelvisFeetData[PelvisFixedFeetDataIndices[PelvisIndex]].FootPlacementFlags[FootIndex] = bPlaceFoot;
+		break;
+
+	case EFootPlacementPelvisSolver::Generic:
+		IKFootPlacementPelvises[PelvisIndex].FootPlacementFlags[FootIndex] = bPlaceFoot;
+		break;
+	}
+}
+
+void UFootPlacementAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	// Get world
+	World = GetWorld();
+
+	// Size the output read by the anim graph for each pelvis and foot. Sized before the owning character is checked so anim graphs previewed in animation editors can
+	// still resolve their property access paths
+	PelvisOutputs.SetNum(IKFootPlacementPelvises.Num());
+	for (int32 i = 0; i < IKFootPlacementPelvises.Num(); ++i)
+	{
+		PelvisOutputs[i].Feet.SetNum(IKFootPlacementPelvises[i].IKFootPlacementFootParams.Num());
+	}
+
+	// Get owning character
+	FootPlacementCharacter = Cast<ACharacter>(TryGetPawnOwner());
+
+	// Character can be null when using animation editors
+#if WITH_EDITOR
+	if (!IsValid(FootPlacementCharacter))
+	{
+		return;
+	}
+#endif
+
+	// Get owning character component references
+	MeshComponent = FootPlacementCharacter->GetMesh();
+	CapsuleComponent = FootPlacementCharacter->GetCapsuleComponent();
+
+	// Initialize foot ik placement system for each pelvis. Pelvises with two or four feet use the fixed foot count solvers, otherwise fall back to the generic solver
+	const int32 NumPelvises = IKFootPlacementPelvises.Num();
+	PelvisSolvers.SetNum(NumPelvises);
+	PelvisFixedFeetDataIndices.SetNum(NumPelvises);
+	BipedPelvisFeetData.Reset();
+	QuadrupedPelvisFeetData.Reset();
+
+	for (int32 i = 0; i < NumPelvises; ++i)
+	{
+		FPelvisFeetData& FeetData = IKFootPlacementPelvises[i];
+
+		switch (FeetData.IKFootPlacementFootParams.Num())
+		{
+		case 2:
+			PelvisSolvers[i] = EFootPlacementPelvisSolver::Biped;
+			PelvisFixedFeetDataIndices[i] = BipedPelvisFeetData.AddDefaulted();
+			UCharacterAnimationLibrary::InitializePelvis(FootPlacementCharacter, FeetData, BipedPelvisFeetData[PelvisFixedFeetDataIndices[i]]);
+			break;
+
+		case 4:
+			PelvisSolvers[i] = EFootPlacementPelvisSolver::Quadruped;
+			PelvisFixedFeetDataIndices[i] = QuadrupedPelvisFeetData.AddDefaulted();
+			UCharacterAnimationLibrary::InitializePelvis(FootPlacementCharacter, FeetData, QuadrupedPelvisFeetData[PelvisFixedFeetDataIndices[i]]);
+			break;
+
+		default:
+			PelvisSolvers[i] = EFootPlacementPelvisSolver::Generic;
+			PelvisFixedFeetDataIndices[i] = INDEX_NONE;
+			UCharacterAnimationLibrary::InitializePelvis(FootPlacementCharacter, FeetData);
+			break;
+		}
+	}
+}
+
+void UFootPlacementAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	// If character and component references are valid. This can be null when viewing animations in the editor
+#if WITH_EDITOR
+	if (!IsValid(FootPlacementCharacter) ||
+		!IsValid(MeshComponent) ||
+		!IsValid(CapsuleComponent))
+	{
+		// Disable character IK
+		IkAlpha = 0.0f;
+
+		return;
+	}
+#endif
+
+	// Get character capsule center world space location
+	CharacterCapsuleCenterWorldLocation = CapsuleComponent->GetComponentLocation();
+
+	// Get character capsule scaled half height
+	CharacterCapsuleHalfHeight = CapsuleComponent->GetScaledCapsuleHalfHeight();
+
+	// Update foot ik placement system for each pelvis
+	for (int32 i = 0; i < PelvisSolvers.Num(); ++i)
+	{
+		switch (PelvisSolvers[i])
+		{
+		case EFootPlacementPelvisSolver::Biped:
+			UCharacterAnimationLibrary::UpdatePelvis(MeshComponent, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight,
+				BipedPelvisFeetData[PelvisFixedFeetDataIndices[i]]);
+			break;
+
+		case EFootPlacementPelvisSolver::Quadruped:
+			UCharacterAnimationLibrary::UpdatePelvis(MeshComponent, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight,
+				QuadrupedPelvisFeetData[PelvisFixedFeetDataIndices[i]]);
+			break;
+
+		case EFootPlacementPelvisSolver::Generic:
+			UCharacterAnimationLibrary::UpdatePelvis(MeshComponent, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight, IKFootPlacementPelvises[i]);
+			break;
+		}
+	}
+}
+
+void UFootPlacementAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	// Update foot ik placement system for each pelvis, interpolating straight into the output read by the anim graph
+	for (int32 i = 0; i < PelvisSolvers.Num(); ++i)
+	{
+		FFootPlacementPelvisOutput& PelvisOutput = PelvisOutputs[i];
+
+		switch (PelvisSolvers[i])
+		{
+		case EFootPlacementPelvisSolver::Biped:
+			UCharacterAnimationLibrary::ThreadSafeUpdatePelvis(World, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight,
+				BipedPelvisFeetData[PelvisFixedFeetDataIndices[i]], DeltaSeconds, IKFootPlacementInterpSpeed, IKFootPlacementSolveRate, PelvisOutput);
+			break;
+
+		case EFootPlacementPelvisSolver::Quadruped:
+			UCharacterAnimationLibrary::ThreadSafeUpdatePelvis(World, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight,
+				QuadrupedPelvisFeetData[PelvisFixedFeetDataIndices[i]], DeltaSeconds, IKFootPlacementInterpSpeed, IKFootPlacementSolveRate, PelvisOutput);
+			break;
+
+		case EFootPlacementPelvisSolver::Generic:
+			UCharacterAnimationLibrary::ThreadSafeUpdatePelvis(World, CharacterCapsuleCenterWorldLocation, CharacterCapsuleHalfHeight, IKFootPlacementPelvises[i],
+				DeltaSeconds, IKFootPlacementInterpSpeed, IKFootPlacementSolveRate, PelvisOutput);
+			break;
+		}
+	}
+}
+
+TArray<FPelvisFeetData>& UFootPlacementAnimInstance::GetFootPlacementPelvises()
+{
+	return IKFootPlacementPelvises;
+}
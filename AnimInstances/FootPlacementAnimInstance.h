@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Project1AnimInstanceBase.h"
+#include "FunctionLibraries/CharacterAnimationLibrary.h"
+#include "FootPlacementAnimInstance.generated.h"
+
+class ACharacter;
+class UCapsuleComponent;
+
+// Foot placement solver used for a pelvis, chosen during initialization from the number of feet attached to it
+enum class EFootPlacementPelvisSolver : uint8
+{
+	Biped,
+	Quadruped,
+	Generic
+};
+
+/**
+ * Base anim instance for characters using the IK foot placement system. Pelvises and feet are defined in data, every pelvis is updated in one pass, and interpolated values
+ * are written straight into per pelvis output structures that the anim graph reads through property access
+ */
+UCLASS(Abstract)
+class UFootPlacementAnimInstance : public UProject1AnimInstanceBase
+{
+	GENERATED_BODY()
+
+private:
+	// Number of pelvises whose solver state is stored inline in the anim instance. Characters with more pelvises allocate
+	static constexpr int32 NumInlinePelvises = 2;
+
+	// Foot placement system properties
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	float IKFootPlacementInterpSpeed;
+
+	// Number of times per second feet are traced. Feet are placed against the last trace hits every animation update, so they still follow the current pose and capsule
+	// between traces. Zero traces every animation update
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement", meta = (ClampMin = "0.0"))
+	float IKFootPlacementSolveRate;
+
+	// One entry for each pelvis the character has, each with any number of feet. Pelvises with 2 or 4 feet use the fixed foot count solvers
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	TArray<FPelvisFeetData> IKFootPlacementPelvises;
+
+	// Computed foot placement system data exposed to blueprint animation system. One entry for each pelvis in IKFootPlacementPelvises, each with one entry for each of its
+	// feet. IK nodes bind to a property access path with constant indices, e.g. PelvisOutputs[0].Feet[1].FootIkEffectorLocation, so nothing is copied out for the anim graph
+	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
+	TArray<FFootPlacementPelvisOutput> PelvisOutputs;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
+	float IkAlpha;
+
+	// Solver and fixed size foot data used by each pelvis. Pelvises with two or four feet use the fixed foot count solvers, others use their FPelvisFeetData directly
+	TArray<EFootPlacementPelvisSolver, TInlineAllocator<NumInlinePelvises>> PelvisSolvers;
+	TArray<int32, TInlineAllocator<NumInlinePelvises>> PelvisFixedFeetDataIndices;
+	TArray<TFixedPelvisFeetData<2>, TInlineAllocator<NumInlinePelvises>> BipedPelvisFeetData;
+	TArray<TFixedPelvisFeetData<4>, TInlineAllocator<NumInlinePelvises>> QuadrupedPelvisFeetData;
+
+	// World reference
+	TObjectPtr<UWorld> World;
+
+	// Owning character references
+	TObjectPtr<ACharacter> FootPlacementCharacter;
+	TObjectPtr<USkeletalMeshComponent> MeshComponent;
+	TObjectPtr<UCapsuleComponent> CapsuleComponent;
+
+	// Data gathered each animation update
+	FVector CharacterCapsuleCenterWorldLocation;
+	float CharacterCapsuleHalfHeight;
+
+public:
+	UFootPlacementAnimInstance();
+
+	// Sets whether a foot should be placed. Called by foot placement anim notify states
+	void SetFootPlacementFlag(const int32 PelvisIndex, const int32 FootIndex, const bool bPlaceFoot);
+
+protected:
+	void NativeInitializeAnimation() override;
+	void NativeUpdateAnimation(float DeltaSeconds) override;
+	void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+	// Used by derived anim instances to migrate foot data saved before they derived from this class
+	TArray<FPelvisFeetData>& GetFootPlacementPelvises();
+};
@@ -3,13 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Project1AnimInstanceBase.h"
-#include "FunctionLibraries/CharacterAnimationLibrary.h"
+#include "Animation/AnimInstances/FootPlacementAnimInstance.h"
 #include "SK_Mannequin_CS3_AnimInstance.generated.h"
 
 class ASK_Mannequin_CS3_Character;
 class UCharacterMovementComponent;
-class UCapsuleComponent;
 
 enum class ECharacterMovementState : uint8;
 
@@ -17,21 +15,20 @@ enum class ECharacterMovementState : uint8;
  *
  */
 UCLASS()
-class USK_Mannequin_CS3_AnimInstance : public UProject1AnimInstanceBase
+class USK_Mannequin_CS3_AnimInstance : public UFootPlacementAnimInstance
 {
 	GENERATED_BODY()
 
 private:
 	// Foot placement system constants
+	static constexpr int32 PelvisIndex = 0;
 	static constexpr int32 FootIndex_L = 0;
 	static constexpr int32 FootIndex_R = 1;
 
-	// Foot placement system properties
-	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
-	float IKFootPlacementInterpSpeed;
-
-	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
-	FPelvisFeetData IKFootPlacementPelvisFeetData;
+	// Deprecated. Feet are now set in the first entry of IKFootPlacementPelvises. Only loaded from existing anim blueprints so it can be moved there in PostLoad. Requires the
+	// IKFootPlacementPelvisFeetData property redirect described in the readme
+	UPROPERTY()
+	FPelvisFeetData IKFootPlacementPelvisFeetData_DEPRECATED;
 
 	// Computed animation data exposed to blueprint animation system
 	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
@@ -43,51 +40,15 @@ private:
 	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
 	bool bShouldRun;
 
-	// Computed foot placement system data exposed to blueprint animation system
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FVector FootIkEffectorLocation_L;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FVector FootIkPoleLocation_L;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FRotator FootIkWorldRotation_L;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FVector FootIkEffectorLocation_R;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FVector FootIkPoleLocation_R;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FRotator FootIkWorldRotation_R;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	FVector PelvisBoneAdditiveWorldTranslation;
-
-	UPROPERTY(BlueprintReadOnly, Category = "Animation", meta = (AllowPrivateAccess = "true"))
-	float IkAlpha;
-
-	// World reference
-	TObjectPtr<UWorld> World;
-
 	// Pointer to the owning character of this anim instance
 	TObjectPtr<ASK_Mannequin_CS3_Character> Character;
 
 	// Owning character's movement component reference
 	TObjectPtr<UCharacterMovementComponent> MovementComponent;
 
-	// Owning character's skeletal mesh component reference
-	TObjectPtr<USkeletalMeshComponent> MeshComponent;
-
-	// Owning character's capsule component reference
-	TObjectPtr<UCapsuleComponent> CapsuleComponent;
-
 	// Data gathered each animation update
 	ECharacterMovementState CharacterMovementState;
 	FVector CurrentCharacterAcceleration;
-	FVector CharacterCapsuleCenterWorldLocation;
-	float CharacterCapsuleHalfHeight;
 
 public:
 	USK_Mannequin_CS3_AnimInstance();
@@ -99,9 +60,8 @@ public:
 	void ANS_RFPlacement_End();
 
 private:
+	void PostLoad() override;
 	void NativeInitializeAnimation() override;
 	void NativeUpdateAnimation(float DeltaSeconds) override;
 	void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
-
-	void CopyFootPlacementDataToOutput();
 };
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ANS_FootPlacement.h"
+#include "Animation/AnimInstances/FootPlacementAnimInstance.h"
+
+void UANS_FootPlacement::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
+
+	// Tick used here instead of begin event as begin event is not always called when animations are blending
+	if (UFootPlacementAnimInstance* FootPlacementAnimInstance = Cast<UFootPlacementAnimInstance>(MeshComp->GetAnimInstance()))
+	{
+		FootPlacementAnimInstance->SetFootPlacementFlag(PelvisIndex, FootIndex, true);
+	}
+}
+
+void UANS_FootPlacement::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+
+	if (UFootPlacementAnimInstance* FootPlacementAnimInstance = Cast<UFootPlacementAnimInstance>(MeshComp->GetAnimInstance()))
+	{
+		FootPlacementAnimInstance->SetFootPlacementFlag(PelvisIndex, FootIndex, false);
+	}
+}
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "ANS_FootPlacement.generated.h"
+
+/**
+ * Marks a foot as placed for the duration of the notify state. Used with anim instances derived from UFootPlacementAnimInstance
+ */
+UCLASS()
+class UANS_FootPlacement : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+private:
+	// Index of the pelvis in the anim instance's foot placement pelvises that the foot is attached to
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement", meta = (ClampMin = "0"))
+	int32 PelvisIndex = 0;
+
+	// Index of the foot in the pelvis' foot placement parameters
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement", meta = (ClampMin = "0"))
+	int32 FootIndex = 0;
+
+private:
+	void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
+	void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+};
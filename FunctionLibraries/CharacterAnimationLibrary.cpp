@@ -4,6 +4,58 @@
 #include "CharacterAnimationLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Templates/IntegerSequence.h"
+
+namespace
+{
+	// Calls FootFunction once for each foot index in the sequence. Used by the fixed foot count solver to unroll per foot loops at compile time
+	template<int32... FootIndices, typename FootFunctionType>
+	FORCEINLINE void UnrollFeet(TIntegerSequence<int32, FootIndices...>, FootFunctionType&& FootFunction)
+	{
+		(FootFunction(FootIndices), ...);
+	}
+
+	// Returns the number of feet attached to the pelvis
+	template<int32 NumFeet>
+	constexpr int32 GetNumSolvedFeet(const TFixedPelvisFeetData<NumFeet>& FeetData)
+	{
+		return NumFeet;
+	}
+
+	FORCEINLINE int32 GetNumSolvedFeet(const FPelvisFeetData& FeetData)
+	{
+		return FeetData.IKFootPlacementFootParams.Num();
+	}
+
+	// Calls FootFunction once for each foot index. Loops over fixed size foot data are unrolled at compile time
+	template<int32 NumFeet, typename FootFunctionType>
+	FORCEINLINE void ForEachSolvedFoot(const TFixedPelvisFeetData<NumFeet>& FeetData, FootFunctionType&& FootFunction)
+	{
+		UnrollFeet(TMakeIntegerSequence<int32, NumFeet>{}, Forward<FootFunctionType>(FootFunction));
+	}
+
+	template<typename FootFunctionType>
+	FORCEINLINE void ForEachSolvedFoot(const FPelvisFeetData& FeetData, FootFunctionType&& FootFunction)
+	{
+		const int32 NumFeet = GetNumSolvedFeet(FeetData);
+		for (int32 i = 0; i < NumFeet; ++i)
+		{
+			FootFunction(i);
+		}
+	}
+
+	// Fixed size foot data is sized during initialization so is always valid
+	template<int32 NumFeet>
+	constexpr bool IsPelvisFeetDataValid(TFixedPelvisFeetData<NumFeet>& FeetData)
+	{
+		return true;
+	}
+
+	FORCEINLINE bool IsPelvisFeetDataValid(FPelvisFeetData& FeetData)
+	{
+		return FeetData.IsValid();
+	}
+}
 
 bool FPelvisFeetData::IsValid()
 {
@@ -16,10 +68,7 @@ bool FPelvisFeetData::IsValid()
 		(FootRaycastHitResults.Num() == NumUserDefinedFeet) &&
 		(TargetFootIKEffectorWorldLocations.Num() == NumUserDefinedFeet) &&
 		(TargetFootWorldRotations.Num() == NumUserDefinedFeet) &&
-		(TargetFootIKPoleWorldLocations.Num() == NumUserDefinedFeet) &&
-		(InterpolatedFootIKEffectorWorldLocations.Num() == NumUserDefinedFeet) &&
-		(InterpolatedFootWorldRotations.Num() == NumUserDefinedFeet) &&
-		(InterpolatedFootIKPoleWorldLocations.Num() == NumUserDefinedFeet);
+		(TargetFootIKPoleWorldLocations.Num() == NumUserDefinedFeet);
 }
 
 void UCharacterAnimationLibrary::InitializePelvis(AActor* OwningCharacterActor, FPelvisFeetData& FeetData)
@@ -38,110 +87,202 @@ void UCharacterAnimationLibrary::InitializePelvis(AActor* OwningCharacterActor,
 	FeetData.TargetFootWorldRotations.SetNumZeroed(NumFeet);
 	FeetData.TargetFootIKPoleWorldLocations.SetNumZeroed(NumFeet);
 
-	FeetData.InterpolatedFootIKEffectorWorldLocations.SetNumZeroed(NumFeet);
-	FeetData.InterpolatedFootWorldRotations.SetNumZeroed(NumFeet);
-	FeetData.InterpolatedFootIKPoleWorldLocations.SetNumZeroed(NumFeet);
+	// Feet are traced on the first update when tracing at a fixed rate
+	FeetData.TraceTimeAccumulator = TNumericLimits<float>::Max();
+
+	// Add owning character as an ignored actor to the foot raycast collision query parameters for each foot. The parameters persist between initializations, so the
+	// character is only added if a previous initialization has not already added it
+	if (!IsValid(OwningCharacterActor))
+	{
+		return;
+	}
 
-	// Add owning character as an ignored actor to the foot raycast collision query parameters for each foot
 	for (int32 i = 0; i < NumFeet; ++i)
 	{
-		FeetData.IKFootPlacementFootParams[i].FootRaycastParams.FootRaycastCollisionQueryParams.AddIgnoredActor(OwningCharacterActor);
+		FCollisionQueryParams& QueryParams = FeetData.IKFootPlacementFootParams[i].FootRaycastParams.FootRaycastCollisionQueryParams;
+		if (!QueryParams.GetIgnoredActors().Contains(OwningCharacterActor->GetUniqueID()))
+		{
+			QueryParams.AddIgnoredActor(OwningCharacterActor);
+		}
 	}
 }
 
-void UCharacterAnimationLibrary::UpdatePelvis(const USkeletalMeshComponent* const CharacterSkeletalMeshComponent,
-	const FVector& CharacterCapsuleCenterWorldLocation,
-	const float CharacterCapsuleHalfHeight,
-	FPelvisFeetData& FeetData)
+void UCharacterAnimationLibrary::RaycastFootForPlacement(FHitResult& OutHit,
+	const TObjectPtr<UWorld> World,
+	const FVector& FootBonePoseWorldLocation,
+	const FQuat& FootBonePoseWorldRotation,
+	const FIKFootPlacementParameters& FootPlacementParams)
 {
-#if WITH_EDITOR
-	if (!FeetData.IsValid())
+	// Probe the whole footprint in one sweep if enabled. Falls back to a raycast when the sweep result cannot be used
+	if (FootPlacementParams.FootRaycastParams.bUseFootprintSweep &&
+		UCharacterAnimationLibrary::SweepFootprintForPlacement(OutHit, World, FootBonePoseWorldLocation, FootBonePoseWorldRotation, FootPlacementParams))
 	{
 		return;
 	}
-#endif // WITH_EDITOR
 
-	// Get number of feet attached to the pelvis
-	const int32 NumFeet = FeetData.IKFootPlacementFootParams.Num();
+	FVector WorldRaycastStart = FootBonePoseWorldLocation;
+	WorldRaycastStart.Z += StaticCast<double>(FootPlacementParams.FootRaycastParams.FootRaycastHeightOffset);
 
-	// Gather foot placement system data
+	FVector WorldRaycastEnd = WorldRaycastStart;
+	WorldRaycastEnd.Z -= FootPlacementParams.FootRaycastParams.FootRaycastDistance;
 
-	// For each foot
-	for (int32 i = 0; i < NumFeet; ++i)
-	{
-		// Get transform of foot ik bone in world space after the skeleton has been posed. Foot ik is performed as a post process step so need the original pose location of the 
-		// foot bone here to probe for terrain collision geometry
-		FeetData.PosedFootBoneWorldTransforms[i] = CharacterSkeletalMeshComponent->GetBoneTransform(FeetData.IKFootPlacementFootParams[i].PosedFootSourceBoneName,
-			ERelativeTransformSpace::RTS_World);
-
-		// Get location of foot ik bone in component space after the skeleton has been posed
-		FeetData.PosedFootBoneComponentLocations[i] = CharacterSkeletalMeshComponent->GetBoneLocation(FeetData.IKFootPlacementFootParams[i].PosedFootSourceBoneName,
-			EBoneSpaces::ComponentSpace);
-	}
+	World->LineTraceSingleByChannel(
+		OutHit,
+		WorldRaycastStart,
+		WorldRaycastEnd,
+		FootPlacementParams.FootRaycastParams.FootRaycastCollisionChannel,
+		FootPlacementParams.FootRaycastParams.FootRaycastCollisionQueryParams);
 }
 
-void UCharacterAnimationLibrary::ThreadSafeUpdatePelvis(UWorld* World,
-	const FVector& CharacterCapsuleCenterWorldLocation,
-	const float CharacterCapsuleHalfHeight,
-	FPelvisFeetData& FeetData,
-	const float DeltaSeconds,
-	const float IKFootPlacementInterpSpeed,
-	FVector& OutPelvisBoneAdditiveWorldTranslation)
+bool UCharacterAnimationLibrary::SweepFootprintForPlacement(FHitResult& OutHit,
+	const TObjectPtr<UWorld> World,
+	const FVector& FootBonePoseWorldLocation,
+	const FQuat& FootBonePoseWorldRotation,
+	const FIKFootPlacementParameters& FootPlacementParams)
 {
-#if WITH_EDITOR
-	if (!FeetData.IsValid())
+	const FFootRaycastParameters& RaycastParams = FootPlacementParams.FootRaycastParams;
+
+	// Orient the footprint along the foot's heel to toe direction in the world horizontal plane
+	FVector FootprintForward = FootBonePoseWorldRotation.RotateVector(RaycastParams.FootprintForwardBoneAxis);
+	FootprintForward.Z = 0.0;
+	if (!FootprintForward.Normalize())
 	{
-		return;
+		FootprintForward = FVector::ForwardVector;
 	}
-#endif // WITH_EDITOR
 
-	// Get number of feet attached to the pelvis
-	const int32 NumFeet = FeetData.IKFootPlacementFootParams.Num();
+	const FQuat FootprintRotation = FRotationMatrix::MakeFromX(FootprintForward).ToQuat();
+	const FCollisionShape FootprintShape = FCollisionShape::MakeBox(FVector(RaycastParams.FootprintLength * 0.5f, RaycastParams.FootprintWidth * 0.5f,
+		UCharacterAnimationLibrary::FootprintSweepHalfHeight));
+
+	// The sweep ends at the same height as the raycast but starts higher so the footprint is clear of any step it overlaps
+	FVector WorldSweepEnd = FootBonePoseWorldLocation + (FootprintForward * StaticCast<double>(RaycastParams.FootprintForwardOffset));
+	WorldSweepEnd.Z += StaticCast<double>(RaycastParams.FootRaycastHeightOffset - RaycastParams.FootRaycastDistance);
+
+	FVector WorldSweepStart = WorldSweepEnd;
+	WorldSweepStart.Z += StaticCast<double>(RaycastParams.FootRaycastDistance + RaycastParams.FootprintSweepHeightOffset);
+
+	// Geometry that blocks the foot probe is only overlapped by the sweep so it reports every shape under the footprint rather than stopping at the first one
+	FCollisionResponseParams FootprintResponseParams;
+	FootprintResponseParams.CollisionResponse.SetAllChannels(ECR_Overlap);
+
+	TArray<FHitResult> FootprintHits;
+	World->SweepMultiByChannel(
+		FootprintHits,
+		WorldSweepStart,
+		WorldSweepEnd,
+		FootprintRotation,
+		RaycastParams.FootRaycastCollisionChannel,
+		FootprintShape,
+		RaycastParams.FootRaycastCollisionQueryParams,
+		FootprintResponseParams);
+
+	// Find the highest support under the heel and toe halves of the footprint
+	const FHitResult* HeelSupportHit = nullptr;
+	const FHitResult* ToeSupportHit = nullptr;
+	bool FootprintStartedPenetrating = false;
+
+	for (const FHitResult& FootprintHit : FootprintHits)
+	{
+		const UPrimitiveComponent* const FootprintHitComponent = FootprintHit.GetComponent();
+		if (!IsValid(FootprintHitComponent) || (FootprintHitComponent->GetCollisionResponseToChannel(RaycastParams.FootRaycastCollisionChannel) != ECR_Block))
+		{
+			continue;
+		}
 
-	// Calculate world space location of the bottom of the character's capsule
-	const FVector CapsuleBottomWorldLocation = FVector(CharacterCapsuleCenterWorldLocation.X,
-		CharacterCapsuleCenterWorldLocation.Y,
-		CharacterCapsuleCenterWorldLocation.Z - StaticCast<double>(CharacterCapsuleHalfHeight));
+		// The footprint started inside this shape so the hit does not describe the ground under the foot. Rare as the sweep starts above the step height
+		if (FootprintHit.bStartPenetrating)
+		{
+			FootprintStartedPenetrating = true;
+			continue;
+		}
 
-	// Allocate foot placement update data
-	FVector TargetPelvisBoneAdditiveWorldTranslation = FVector::ZeroVector;
+		const bool IsHeelSupport = FVector::DotProduct(FootprintHit.ImpactPoint - FootprintHit.Location, FootprintForward) < 0.0;
+		const FHitResult*& SupportHit = (IsHeelSupport) ? HeelSupportHit : ToeSupportHit;
 
-	// Calculate feet
-	for (int32 i = 0; i < NumFeet; ++i)
+		if ((SupportHit == nullptr) || (FootprintHit.ImpactPoint.Z > SupportHit->ImpactPoint.Z))
+		{
+			SupportHit = &FootprintHit;
+		}
+	}
+
+	if ((HeelSupportHit == nullptr) && (ToeSupportHit == nullptr))
 	{
-		UCharacterAnimationLibrary::ComputeFoot(World, FeetData.PosedFootBoneWorldTransforms[i].GetLocation(), FeetData.PosedFootBoneWorldTransforms[i].GetRotation(),
-			FeetData.PosedFootBoneComponentLocations[i], FeetData.IKFootPlacementFootParams[i], FeetData.FootPlacementFlags[i], FeetData.FootRaycastHitResults[i],
-			FeetData.TargetFootIKEffectorWorldLocations[i], FeetData.TargetFootWorldRotations[i], FeetData.TargetFootIKPoleWorldLocations[i]);
+		OutHit = FHitResult(WorldSweepStart, WorldSweepEnd);
+		return !FootprintStartedPenetrating;
 	}
 
-	// Calculate pelvis
-	UCharacterAnimationLibrary::ComputePelvis(FeetData.FootRaycastHitResults.GetData(), NumFeet, CapsuleBottomWorldLocation, TargetPelvisBoneAdditiveWorldTranslation,
-		FeetData.TargetFootIKEffectorWorldLocations.GetData());
-
-	// Interpolate foot placement values
-	UCharacterAnimationLibrary::InterpolateFootPlacementValues(FeetData.TargetFootIKEffectorWorldLocations.GetData(), FeetData.TargetFootWorldRotations.GetData(),
-		FeetData.TargetFootIKPoleWorldLocations.GetData(), TargetPelvisBoneAdditiveWorldTranslation, NumFeet, DeltaSeconds, IKFootPlacementInterpSpeed,
-		FeetData.InterpolatedFootIKEffectorWorldLocations.GetData(), FeetData.InterpolatedFootWorldRotations.GetData(), FeetData.InterpolatedFootIKPoleWorldLocations.GetData(),
-		OutPelvisBoneAdditiveWorldTranslation);
+	// The highest support describes the surface the footprint first rests on
+	const FHitResult& HighestSupportHit = ((HeelSupportHit == nullptr) || ((ToeSupportHit != nullptr) && (ToeSupportHit->ImpactPoint.Z > HeelSupportHit->ImpactPoint.Z))) ?
+		*ToeSupportHit : *HeelSupportHit;
+
+	FVector ContactPoint = HighestSupportHit.ImpactPoint;
+	FVector ContactNormal = HighestSupportHit.ImpactNormal;
+
+	if ((HeelSupportHit != nullptr) && (ToeSupportHit != nullptr))
+	{
+		// Fit the contact plane through both support points. The plane contains the heel to toe line and is tilted about it as little as possible from the supports' surfaces
+		const FVector HeelToToe = ToeSupportHit->ImpactPoint - HeelSupportHit->ImpactPoint;
+		const FVector SupportSide = FVector::CrossProduct(HeelSupportHit->ImpactNormal + ToeSupportHit->ImpactNormal, HeelToToe);
+		FVector FittedNormal = FVector::CrossProduct(HeelToToe, SupportSide);
+
+		if (FittedNormal.Normalize() && (FittedNormal.Z > UE_KINDA_SMALL_NUMBER))
+		{
+			ContactPoint = HeelSupportHit->ImpactPoint;
+			ContactNormal = FittedNormal;
+		}
+	}
+
+	// Place the hit location on the contact plane directly below the foot bone
+	FVector FootContactLocation = FootBonePoseWorldLocation;
+	FootContactLocation.Z = (FMath::Abs(ContactNormal.Z) > UE_KINDA_SMALL_NUMBER) ?
+		ContactPoint.Z - (((ContactNormal.X * (FootContactLocation.X - ContactPoint.X)) + (ContactNormal.Y * (FootContactLocation.Y - ContactPoint.Y))) / ContactNormal.Z) :
+		ContactPoint.Z;
+
+	OutHit = HighestSupportHit;
+	OutHit.bBlockingHit = true;
+	OutHit.Location = FootContactLocation;
+	OutHit.Normal = ContactNormal;
+
+	return true;
 }
 
-void UCharacterAnimationLibrary::RaycastFootForPlacement(FHitResult& OutHit,
-	const TObjectPtr<UWorld> World,
-	const FVector& FootBonePoseWorldLocation,
-	const FIKFootPlacementParameters& FootPlacementParams)
+void UCharacterAnimationLibrary::ProjectFootRaycastHitBelowFoot(FHitResult& FootRaycastHitResult, const FVector& FootBonePoseWorldLocation)
 {
-	FVector WorldRaycastStart = FootBonePoseWorldLocation;
-	WorldRaycastStart.Z += StaticCast<double>(FootPlacementParams.FootRaycastParams.FootRaycastHeightOffset);
+	if (!FootRaycastHitResult.bBlockingHit)
+	{
+		return;
+	}
 
-	FVector WorldRaycastEnd = WorldRaycastStart;
-	WorldRaycastEnd.Z -= FootPlacementParams.FootRaycastParams.FootRaycastDistance;
+	// Slide the hit location along the plane of the hit surface until it is directly below the foot bone
+	const FVector& HitNormal = FootRaycastHitResult.Normal;
+	const FVector& HitLocation = FootRaycastHitResult.Location;
 
-	World->LineTraceSingleByChannel(
-		OutHit,
-		WorldRaycastStart,
-		WorldRaycastEnd,
-		FootPlacementParams.FootRaycastParams.FootRaycastCollisionChannel,
-		FootPlacementParams.FootRaycastParams.FootRaycastCollisionQueryParams);
+	FVector FootHitLocation = FootBonePoseWorldLocation;
+	FootHitLocation.Z = (FMath::Abs(HitNormal.Z) > UE_KINDA_SMALL_NUMBER) ?
+		HitLocation.Z - (((HitNormal.X * (FootHitLocation.X - HitLocation.X)) + (HitNormal.Y * (FootHitLocation.Y - HitLocation.Y))) / HitNormal.Z) :
+		HitLocation.Z;
+
+	FootRaycastHitResult.Location = FootHitLocation;
+}
+
+bool UCharacterAnimationLibrary::AdvanceFixedRateTrace(float& TraceTimeAccumulator, const float DeltaSeconds, const float TraceRate)
+{
+	if (TraceRate <= 0.0f)
+	{
+		return true;
+	}
+
+	// Accumulated time is clamped to one trace step so a long frame does not cause traces to be run back to back
+	const float TraceStepSeconds = 1.0f / TraceRate;
+	TraceTimeAccumulator = FMath::Min(TraceTimeAccumulator + DeltaSeconds, TraceStepSeconds);
+
+	if (TraceTimeAccumulator < TraceStepSeconds)
+	{
+		return false;
+	}
+
+	TraceTimeAccumulator -= TraceStepSeconds;
+	return true;
 }
 
 FVector UCharacterAnimationLibrary::CalculateFootPlacementLocation(const FHitResult& FootPlacementRaycastResult, const float FootBoneHeight)
@@ -166,35 +307,22 @@ double UCharacterAnimationLibrary::CalculateAdditivePelvisBoneVerticalTranslatio
 	const int32 NumFeet,
 	const double CapsuleBottomWorldSpaceVerticalLocation)
 {
-	// If no foot raycast found collision geometry, do not offset the pelvis by any amount
+	// Find the lowest foot raycast hit relative to the bottom of the capsule. If no foot raycast found collision geometry, do not offset the pelvis by any amount
 	bool FootFoundCollision = false;
-	for (int32 i = 0; i < NumFeet; ++i)
-	{
-		if ((FootRaycastHitResultContiguousStorageStart + i)->bBlockingHit)
-		{
-			FootFoundCollision = true;
-			break;
-		}
-	}
-
-	if (!FootFoundCollision)
-	{
-		return 0.0;
-	}
-
-	// Heap allocation
-	TArray<double>  FootVerticalOffsets = {};
-	FootVerticalOffsets.Reserve(NumFeet);
+	double MinFootVerticalOffset = UE_DOUBLE_BIG_NUMBER;
 
 	for (int32 i = 0; i < NumFeet; ++i)
 	{
 		const FHitResult& HitResult = *(FootRaycastHitResultContiguousStorageStart + i);
 
-		FootVerticalOffsets.Emplace((HitResult.bBlockingHit) ?
-			(HitResult.Location.Z - CapsuleBottomWorldSpaceVerticalLocation) : UE_DOUBLE_BIG_NUMBER);
+		if (HitResult.bBlockingHit)
+		{
+			FootFoundCollision = true;
+			MinFootVerticalOffset = FMath::Min(MinFootVerticalOffset, HitResult.Location.Z - CapsuleBottomWorldSpaceVerticalLocation);
+		}
 	}
 
-	return FMath::Min(FootVerticalOffsets);
+	return (FootFoundCollision) ? MinFootVerticalOffset : 0.0;
 }
 
 void UCharacterAnimationLibrary::ComputeFoot(UWorld* const World,
@@ -211,20 +339,35 @@ void UCharacterAnimationLibrary::ComputeFoot(UWorld* const World,
 	UCharacterAnimationLibrary::RaycastFootForPlacement(OutFootRaycastHitResult,
 		World,
 		FootBonePoseWorldSpaceLocation,
+		FootBonePoseWorldSpaceRotation,
 		FootPlacementParameters);
 
-	OutTargetFootIkEffectorWorldSpaceLocation = (OutFootRaycastHitResult.bBlockingHit) ?
-		UCharacterAnimationLibrary::CalculateFootPlacementLocation(OutFootRaycastHitResult, FootPlacementParameters.FootBoneHeight) :
+	UCharacterAnimationLibrary::PlaceFoot(FootBonePoseWorldSpaceLocation, FootBonePoseWorldSpaceRotation, FootBonePoseComponentSpaceLocation, FootPlacementParameters,
+		PlaceFootFlag, OutFootRaycastHitResult, OutTargetFootIkEffectorWorldSpaceLocation, OutTargetFootWorldSpaceRotation, OutTargetFootIkPoleWorldSpaceLocation);
+}
+
+void UCharacterAnimationLibrary::PlaceFoot(const FVector& FootBonePoseWorldSpaceLocation,
+	const FQuat& FootBonePoseWorldSpaceRotation,
+	const FVector& FootBonePoseComponentSpaceLocation,
+	const FIKFootPlacementParameters& FootPlacementParameters,
+	const bool PlaceFootFlag,
+	const FHitResult& FootRaycastHitResult,
+	FVector& OutTargetFootIkEffectorWorldSpaceLocation,
+	FRotator& OutTargetFootWorldSpaceRotation,
+	FVector& OutTargetFootIkPoleWorldSpaceLocation)
+{
+	OutTargetFootIkEffectorWorldSpaceLocation = (FootRaycastHitResult.bBlockingHit) ?
+		UCharacterAnimationLibrary::CalculateFootPlacementLocation(FootRaycastHitResult, FootPlacementParameters.FootBoneHeight) :
 		FootBonePoseWorldSpaceLocation;
 
-	if (OutFootRaycastHitResult.bBlockingHit)
+	if (FootRaycastHitResult.bBlockingHit)
 	{
 		if (PlaceFootFlag)
 		{
-			OutTargetFootIkEffectorWorldSpaceLocation = UCharacterAnimationLibrary::CalculateFootPlacementLocation(OutFootRaycastHitResult, FootPlacementParameters.FootBoneHeight);
+			OutTargetFootIkEffectorWorldSpaceLocation = UCharacterAnimationLibrary::CalculateFootPlacementLocation(FootRaycastHitResult, FootPlacementParameters.FootBoneHeight);
 
 			OutTargetFootWorldSpaceRotation = UKismetMathLibrary::ComposeRotators(FootBonePoseWorldSpaceRotation.Rotator(),
-				UCharacterAnimationLibrary::CalculateFootPlacementAdditiveRotation(OutFootRaycastHitResult, FootPlacementParameters.FootAdditivePitchValueConstraint,
+				UCharacterAnimationLibrary::CalculateFootPlacementAdditiveRotation(FootRaycastHitResult, FootPlacementParameters.FootAdditivePitchValueConstraint,
 					FootPlacementParameters.FootAdditiveRoleValueConstraint)
 			);
 		}
@@ -232,7 +375,7 @@ void UCharacterAnimationLibrary::ComputeFoot(UWorld* const World,
 		{
 			// If placement for the foot is not active, need to add component space height of the posed bone to the calculated foot placement location's world up component (Z axis)
 			// without a foot bone height offset
-			OutTargetFootIkEffectorWorldSpaceLocation = UCharacterAnimationLibrary::CalculateFootPlacementLocation(OutFootRaycastHitResult, 0.0f);
+			OutTargetFootIkEffectorWorldSpaceLocation = UCharacterAnimationLibrary::CalculateFootPlacementLocation(FootRaycastHitResult, 0.0f);
 			OutTargetFootIkEffectorWorldSpaceLocation.Z += FootBonePoseComponentSpaceLocation.Z;
 
 			OutTargetFootWorldSpaceRotation = FootBonePoseWorldSpaceRotation.Rotator();
@@ -316,3 +459,202 @@ void UCharacterAnimationLibrary::InterpolateFootPlacementValues(const FVector* c
 				InterpolationSpeed);
 	}
 }
+
+template<int32 NumFeet>
+bool UCharacterAnimationLibrary::InitializePelvis(AActor* OwningCharacterActor, const FPelvisFeetData& SourceFeetData, TFixedPelvisFeetData<NumFeet>& FeetData)
+{
+	// Fixed size data can only be used when the number of user defined feet matches the number of feet it was compiled for
+	if (SourceFeetData.IKFootPlacementFootParams.Num() != NumFeet)
+	{
+		return false;
+	}
+
+	UnrollFeet(TMakeIntegerSequence<int32, NumFeet>{}, [&](const int32 i)
+		{
+			// Copy user defined foot parameters and add owning character as an ignored actor to the foot raycast collision query parameters
+			FeetData.IKFootPlacementFootParams[i] = SourceFeetData.IKFootPlacementFootParams[i];
+			FeetData.IKFootPlacementFootParams[i].FootRaycastParams.FootRaycastCollisionQueryParams.AddIgnoredActor(OwningCharacterActor);
+
+			// Initialize foot data
+			FeetData.PosedFootBoneWorldTransforms[i] = FTransform::Identity;
+			FeetData.FootPlacementFlags[i] = false;
+			FeetData.PosedFootBoneComponentLocations[i] = FVector::ZeroVector;
+
+			FeetData.FootRaycastHitResults[i] = FHitResult();
+
+			FeetData.TargetFootIKEffectorWorldLocations[i] = FVector::ZeroVector;
+			FeetData.TargetFootWorldRotations[i] = FRotator::ZeroRotator;
+			FeetData.TargetFootIKPoleWorldLocations[i] = FVector::ZeroVector;
+		});
+
+	// Feet are traced on the first update when tracing at a fixed rate
+	FeetData.TraceTimeAccumulator = TNumericLimits<float>::Max();
+
+	return true;
+}
+
+template<typename PelvisFeetDataType>
+void UCharacterAnimationLibrary::UpdatePelvis(const USkeletalMeshComponent* const CharacterSkeletalMeshComponent,
+	const FVector& CharacterCapsuleCenterWorldLocation,
+	const float CharacterCapsuleHalfHeight,
+	PelvisFeetDataType& FeetData)
+{
+#if WITH_EDITOR
+	if (!IsPelvisFeetDataValid(FeetData))
+	{
+		return;
+	}
+#endif // WITH_EDITOR
+
+	// Gather foot placement system data for each foot
+	ForEachSolvedFoot(FeetData, [&](const int32 i)
+		{
+			// Get transform of foot ik bone in world space after the skeleton has been posed. Foot ik is performed as a post process step so need the original pose location of the 
+			// foot bone here to probe for terrain collision geometry
+			FeetData.PosedFootBoneWorldTransforms[i] = CharacterSkeletalMeshComponent->GetBoneTransform(FeetData.IKFootPlacementFootParams[i].PosedFootSourceBoneName,
+				ERelativeTransformSpace::RTS_World);
+
+			// Get location of foot ik bone in component space after the skeleton has been posed
+			FeetData.PosedFootBoneComponentLocations[i] = CharacterSkeletalMeshComponent->GetBoneLocation(FeetData.IKFootPlacementFootParams[i].PosedFootSourceBoneName,
+				EBoneSpaces::ComponentSpace);
+		});
+}
+
+template<typename PelvisFeetDataType>
+void UCharacterAnimationLibrary::ThreadSafeUpdatePelvis(UWorld* World,
+	const FVector& CharacterCapsuleCenterWorldLocation,
+	const float CharacterCapsuleHalfHeight,
+	PelvisFeetDataType& FeetData,
+	const float DeltaSeconds,
+	const float IKFootPlacementInterpSpeed,
+	const float IKFootPlacementSolveRate,
+	FFootPlacementPelvisOutput& Output)
+{
+#if WITH_EDITOR
+	if (!IsPelvisFeetDataValid(FeetData) || (Output.Feet.Num() != GetNumSolvedFeet(FeetData)))
+	{
+		return;
+	}
+#endif // WITH_EDITOR
+
+	// Calculate world space location of the bottom of the character's capsule
+	const FVector CapsuleBottomWorldLocation = FVector(CharacterCapsuleCenterWorldLocation.X,
+		CharacterCapsuleCenterWorldLocation.Y,
+		CharacterCapsuleCenterWorldLocation.Z - StaticCast<double>(CharacterCapsuleHalfHeight));
+
+	// Only the scene queries run at the fixed rate. Feet and pelvis are solved against the current pose every update so targets do not trail the character
+	const bool bTraceFeet = UCharacterAnimationLibrary::AdvanceFixedRateTrace(FeetData.TraceTimeAccumulator, DeltaSeconds, IKFootPlacementSolveRate);
+
+	FVector TargetPelvisBoneAdditiveWorldTranslation = FVector::ZeroVector;
+	UCharacterAnimationLibrary::SolvePelvis(World, CapsuleBottomWorldLocation, FeetData, bTraceFeet, TargetPelvisBoneAdditiveWorldTranslation);
+
+	UCharacterAnimationLibrary::InterpolateFootPlacementValuesToOutput(FeetData, TargetPelvisBoneAdditiveWorldTranslation, DeltaSeconds, IKFootPlacementInterpSpeed, Output);
+}
+
+template<typename PelvisFeetDataType>
+void UCharacterAnimationLibrary::SolvePelvis(UWorld* const World,
+	const FVector& CharacterCapsuleBottomWorldSpaceLocation,
+	PelvisFeetDataType& FeetData,
+	const bool bTraceFeet,
+	FVector& OutTargetPelvisBoneAdditiveWorldSpaceTranslation)
+{
+	// Calculate feet
+	ForEachSolvedFoot(FeetData, [&](const int32 i)
+		{
+			const FVector FootBonePoseWorldLocation = FeetData.PosedFootBoneWorldTransforms[i].GetLocation();
+			const FQuat FootBonePoseWorldRotation = FeetData.PosedFootBoneWorldTransforms[i].GetRotation();
+
+			if (bTraceFeet)
+			{
+				UCharacterAnimationLibrary::RaycastFootForPlacement(FeetData.FootRaycastHitResults[i], World, FootBonePoseWorldLocation, FootBonePoseWorldRotation,
+					FeetData.IKFootPlacementFootParams[i]);
+			}
+			else
+			{
+				UCharacterAnimationLibrary::ProjectFootRaycastHitBelowFoot(FeetData.FootRaycastHitResults[i], FootBonePoseWorldLocation);
+			}
+
+			UCharacterAnimationLibrary::PlaceFoot(FootBonePoseWorldLocation, FootBonePoseWorldRotation, FeetData.PosedFootBoneComponentLocations[i],
+				FeetData.IKFootPlacementFootParams[i], FeetData.FootPlacementFlags[i], FeetData.FootRaycastHitResults[i], FeetData.TargetFootIKEffectorWorldLocations[i],
+				FeetData.TargetFootWorldRotations[i], FeetData.TargetFootIKPoleWorldLocations[i]);
+		});
+
+	// Calculate pelvis
+	UCharacterAnimationLibrary::ComputePelvis(FeetData, CharacterCapsuleBottomWorldSpaceLocation, OutTargetPelvisBoneAdditiveWorldSpaceTranslation);
+}
+
+template<typename PelvisFeetDataType>
+void UCharacterAnimationLibrary::ComputePelvis(PelvisFeetDataType& FeetData,
+	const FVector& CharacterCapsuleBottomWorldSpaceLocation,
+	FVector& OutTargetPelvisBoneAdditiveWorldSpaceTranslation)
+{
+	// Find the lowest foot raycast hit relative to the bottom of the capsule. If no foot raycast found collision geometry, do not offset the pelvis by any amount
+	bool FootFoundCollision = false;
+	double MinFootVerticalOffset = UE_DOUBLE_BIG_NUMBER;
+
+	ForEachSolvedFoot(FeetData, [&](const int32 i)
+		{
+			const FHitResult& HitResult = FeetData.FootRaycastHitResults[i];
+
+			if (HitResult.bBlockingHit)
+			{
+				FootFoundCollision = true;
+				MinFootVerticalOffset = FMath::Min(MinFootVerticalOffset, HitResult.Location.Z - CharacterCapsuleBottomWorldSpaceLocation.Z);
+			}
+		});
+
+	OutTargetPelvisBoneAdditiveWorldSpaceTranslation.Z = (FootFoundCollision) ? MinFootVerticalOffset : 0.0;
+
+	// We have moved the pelvis by above amount. If there is no collision found from a foot raycast, the foot should be moved by the same amount
+	ForEachSolvedFoot(FeetData, [&](const int32 i)
+		{
+			if (!FeetData.FootRaycastHitResults[i].bBlockingHit)
+			{
+				FeetData.TargetFootIKEffectorWorldLocations[i].Z += OutTargetPelvisBoneAdditiveWorldSpaceTranslation.Z;
+			}
+		});
+}
+
+template<typename PelvisFeetDataType>
+void UCharacterAnimationLibrary::InterpolateFootPlacementValuesToOutput(const PelvisFeetDataType& FeetData,
+	const FVector& TargetPelvisBoneAdditiveWorldSpaceTranslation,
+	const float DeltaSeconds,
+	const float InterpolationSpeed,
+	FFootPlacementPelvisOutput& Output)
+{
+	ForEachSolvedFoot(FeetData, [&](const int32 i)
+		{
+			FFootPlacementFootOutput& FootOutput = Output.Feet[i];
+
+			// Foot ik effector location
+			FootOutput.FootIkEffectorLocation = FMath::VInterpTo(FootOutput.FootIkEffectorLocation, FeetData.TargetFootIKEffectorWorldLocations[i], DeltaSeconds,
+				InterpolationSpeed);
+
+			// Foot rotation
+			FootOutput.FootIkWorldRotation = FMath::RInterpTo(FootOutput.FootIkWorldRotation, FeetData.TargetFootWorldRotations[i], DeltaSeconds, InterpolationSpeed);
+
+			// Foot ik pole target location
+			FootOutput.FootIkPoleLocation = FMath::VInterpTo(FootOutput.FootIkPoleLocation, FeetData.TargetFootIKPoleWorldLocations[i], DeltaSeconds, InterpolationSpeed);
+
+			// Pelvis additive translation. Interpolated once per foot to match InterpolateFootPlacementValues
+			Output.PelvisBoneAdditiveWorldTranslation = FMath::VInterpTo(Output.PelvisBoneAdditiveWorldTranslation, TargetPelvisBoneAdditiveWorldSpaceTranslation,
+				DeltaSeconds, InterpolationSpeed);
+		});
+}
+
+// Explicit instantiations of the pelvis update for the generic foot data and the fixed foot count solver for bipeds and quadrupeds
+#define IMPLEMENT_PELVIS_UPDATE(PelvisFeetDataType) \
+	template void UCharacterAnimationLibrary::UpdatePelvis<PelvisFeetDataType>(const USkeletalMeshComponent* const, const FVector&, const float, PelvisFeetDataType&); \
+	template void UCharacterAnimationLibrary::ThreadSafeUpdatePelvis<PelvisFeetDataType>(UWorld*, const FVector&, const float, PelvisFeetDataType&, const float, const float, \
+		const float, FFootPlacementPelvisOutput&);
+
+#define IMPLEMENT_FIXED_FOOT_COUNT_SOLVER(NumFeet) \
+	template bool UCharacterAnimationLibrary::InitializePelvis<NumFeet>(AActor*, const FPelvisFeetData&, TFixedPelvisFeetData<NumFeet>&); \
+	IMPLEMENT_PELVIS_UPDATE(TFixedPelvisFeetData<NumFeet>)
+
+IMPLEMENT_PELVIS_UPDATE(FPelvisFeetData)
+IMPLEMENT_FIXED_FOOT_COUNT_SOLVER(2)
+IMPLEMENT_FIXED_FOOT_COUNT_SOLVER(4)
+
+#undef IMPLEMENT_FIXED_FOOT_COUNT_SOLVER
+#undef IMPLEMENT_PELVIS_UPDATE
@@ -40,7 +40,34 @@ struct FFootRaycastParameters
 	UPROPERTY(EditDefaultsOnly)
 	TEnumAsByte<ECollisionChannel> FootRaycastCollisionChannel = ECC_Visibility;
 
-	// Not exposed to blueprint, setup from code. Can be used to add ignored actors to the raycast
+	// When true the foot probe sweeps a box covering the foot's footprint instead of tracing a line under the foot bone. The foot is placed on a contact plane fitted from the
+	// sweep so it rests on the highest support under the heel and toe, e.g. on the edge of a step
+	UPROPERTY(EditDefaultsOnly)
+	bool bUseFootprintSweep = false;
+
+	// Heel to toe length of the footprint swept when bUseFootprintSweep is true
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bUseFootprintSweep", ClampMin = "0.0"))
+	float FootprintLength = 25.0f;
+
+	// Width of the footprint swept when bUseFootprintSweep is true
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bUseFootprintSweep", ClampMin = "0.0"))
+	float FootprintWidth = 10.0f;
+
+	// Distance the center of the footprint is offset in front of the foot bone
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bUseFootprintSweep"))
+	float FootprintForwardOffset = 5.0f;
+
+	// Axis in the foot bone's local space that points from heel to toe. Used to orient the footprint
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bUseFootprintSweep"))
+	FVector FootprintForwardBoneAxis = FVector::ForwardVector;
+
+	// Vertical distance the footprint sweep starts above the foot probe start location. The sweep still ends FootRaycastDistance below the foot probe start location. The
+	// footprint covers the toe, which rests inside the next step when standing on stairs, so the sweep is started above the step height to avoid starting in penetration
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bUseFootprintSweep", ClampMin = "0.0"))
+	float FootprintSweepHeightOffset = 50.0f;
+
+	// Not exposed to blueprint, setup from code. Can be used to add ignored actors to the raycast. The foot placement system adds the owning character when a pelvis is
+	// initialized and leaves any other ignored actors in place
 	FCollisionQueryParams FootRaycastCollisionQueryParams = {};
 };
 
@@ -100,13 +127,68 @@ struct FPelvisFeetData
 	TArray<FRotator> TargetFootWorldRotations = {};
 	TArray<FVector> TargetFootIKPoleWorldLocations = {};
 
-	TArray<FVector> InterpolatedFootIKEffectorWorldLocations = {};
-	TArray<FRotator> InterpolatedFootWorldRotations = {};
-	TArray<FVector> InterpolatedFootIKPoleWorldLocations = {};
+	// Used internally by foot placement system when tracing at a fixed rate. Time accumulated since feet were last traced
+	float TraceTimeAccumulator = 0.0f;
 
 	bool IsValid();
 };
 
+// Fixed size counterpart of FPelvisFeetData for a pelvis with a number of feet known at compile time (2 for bipeds, 4 for quadrupeds). Filled out from a user defined
+// FPelvisFeetData once during initialization so the per frame update does not need to validate array sizes
+template<int32 NumFeet>
+struct TFixedPelvisFeetData
+{
+	static_assert(NumFeet > 0, "A pelvis must have at least one foot attached to it");
+
+	// Copied from the user defined FPelvisFeetData during initialization
+	FIKFootPlacementParameters IKFootPlacementFootParams[NumFeet];
+
+	// Used internally by foot placement system
+	FTransform PosedFootBoneWorldTransforms[NumFeet];
+	bool FootPlacementFlags[NumFeet] = {};
+	FVector PosedFootBoneComponentLocations[NumFeet];
+
+	FHitResult FootRaycastHitResults[NumFeet];
+
+	FVector TargetFootIKEffectorWorldLocations[NumFeet];
+	FRotator TargetFootWorldRotations[NumFeet];
+	FVector TargetFootIKPoleWorldLocations[NumFeet];
+
+	// Used internally by foot placement system when tracing at a fixed rate
+	float TraceTimeAccumulator = 0.0f;
+};
+
+// Interpolated foot placement values for a single foot, read by anim graph nodes through property access
+USTRUCT(BlueprintType)
+struct FFootPlacementFootOutput
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector FootIkEffectorLocation = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector FootIkPoleLocation = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FRotator FootIkWorldRotation = FRotator::ZeroRotator;
+};
+
+// Interpolated foot placement values for a pelvis and the feet attached to it. The foot placement system writes interpolated values straight into this structure so they do
+// not need to be copied out for the anim graph. Anim graph nodes read a foot through a property access path with a constant index, e.g. Feet[1].FootIkEffectorLocation
+USTRUCT(BlueprintType)
+struct FFootPlacementPelvisOutput
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector PelvisBoneAdditiveWorldTranslation = FVector::ZeroVector;
+
+	// One entry for each foot attached to the pelvis, in the same order as the pelvis' foot parameters. Sized by the owner of the output when the pelvis is initialized
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FFootPlacementFootOutput> Feet = {};
+};
+
 /**
  *
  */
@@ -119,34 +201,28 @@ public:
 	// Call during animation intialize event in a character's anim instance for each pelvis the character has with the relevant FPelvisFeetData structure for the pelvis.
 	static void InitializePelvis(AActor* OwningCharacterActor, FPelvisFeetData& FeetData);
 
-	// Call during animation update event in a character's anim instance for each pelvis the character has with the relevant FPelvisFeetData structure for the pelvis.
-	static void UpdatePelvis(const USkeletalMeshComponent* const CharacterSkeletalMeshComponent, const FVector& CharacterCapsuleCenterWorldLocation,
-		const float CharacterCapsuleHalfHeight, FPelvisFeetData& FeetData);
-
-	// Call during animation thread safe update event in a character's anim instance for each pelvis the character has with the relevant FPelvisFeetData structure for the pelvis
-	static void ThreadSafeUpdatePelvis(UWorld* World, const FVector& CharacterCapsuleCenterWorldLocation, const float CharacterCapsuleHalfHeight, FPelvisFeetData& FeetData,
-		const float DeltaSeconds, const float IKFootPlacementInterpSpeed, FVector& OutPelvisBoneAdditiveWorldTranslation);
-
-private:
-	// Performs a raycast for a foot. Returns through the input parameter the hit result of the raycast. Used as part of a character's foot IK placement system
-	static void RaycastFootForPlacement(FHitResult& OutHit,
-		const TObjectPtr<UWorld> World,
-		const FVector& FootBonePoseWorldLocation,
-		const FIKFootPlacementParameters& FootPlacementParams);
-
-	// Returns the foot bone location to place the foot on top of the hit geometry
-	static FVector CalculateFootPlacementLocation(const FHitResult& FootPlacementRaycastResult, const float FootBoneHeight);
-
-	// Returns the additive rotation to align the foot with the hit geometry
-	static FRotator CalculateFootPlacementAdditiveRotation(const FHitResult& FootPlacementRaycastResult,
-		const FValueConstraint& AdditivePitchConstraint,
-		const FValueConstraint& AdditiveRollConstraint);
-
-	// Returns the additive translation to add to the pelvis bone in the vertical up axis to correct pelvis location when placing feet on world collision geometry
-	static double CalculateAdditivePelvisBoneVerticalTranslationForFootPlacement(const FHitResult* const FootRaycastHitResultContiguousStorageStart,
-		const int32 NumFeet,
-		const double CapsuleBottomWorldSpaceVerticalLocation);
+	// Fixed foot count version of the above. Instantiated for 2 and 4 feet. Copies the user defined foot parameters into the fixed size data and returns false if the number
+	// of user defined feet does not match NumFeet, in which case the FPelvisFeetData version should be used instead
+	template<int32 NumFeet>
+	static bool InitializePelvis(AActor* OwningCharacterActor, const FPelvisFeetData& SourceFeetData, TFixedPelvisFeetData<NumFeet>& FeetData);
 
+	// Call during animation update event in a character's anim instance for each pelvis the character has with the relevant foot data for the pelvis. Instantiated for
+	// FPelvisFeetData and TFixedPelvisFeetData with 2 and 4 feet
+	template<typename PelvisFeetDataType>
+	static void UpdatePelvis(const USkeletalMeshComponent* const CharacterSkeletalMeshComponent, const FVector& CharacterCapsuleCenterWorldLocation,
+		const float CharacterCapsuleHalfHeight, PelvisFeetDataType& FeetData);
+
+	// Call during animation thread safe update event in a character's anim instance for each pelvis the character has with the relevant foot data for the pelvis. Interpolated
+	// values are written straight into an output structure read by the anim graph, which holds the interpolated state for the pelvis. When IKFootPlacementSolveRate is greater than zero,
+	// feet are only traced that many times per second using accumulated time. Feet are still placed against the last trace hits every update, so targets follow the current
+	// pose and capsule. Otherwise feet are traced every update. Output.Feet must have one entry for each foot attached to the pelvis. Instantiated for FPelvisFeetData and
+	// TFixedPelvisFeetData with 2 and 4 feet
+	template<typename PelvisFeetDataType>
+	static void ThreadSafeUpdatePelvis(UWorld* World, const FVector& CharacterCapsuleCenterWorldLocation, const float CharacterCapsuleHalfHeight, PelvisFeetDataType& FeetData,
+		const float DeltaSeconds, const float IKFootPlacementInterpSpeed, const float IKFootPlacementSolveRate, FFootPlacementPelvisOutput& Output);
+
+	// Individual steps of a pelvis update operating on contiguous storage. Used by systems that keep foot state in their own storage rather than in FPelvisFeetData, e.g. the
+	// crowd foot placement processor
 	static void ComputeFoot(UWorld* const World,
 		const FVector& FootBonePoseWorldSpaceLocation,
 		const FQuat& FootBonePoseWorldSpaceRotation,
@@ -158,6 +234,17 @@ private:
 		FRotator& OutTargetFootWorldSpaceRotation,
 		FVector& OutTargetFootIkPoleWorldSpaceLocation);
 
+	// Placement part of ComputeFoot. Computes target foot values from an existing foot raycast hit without querying the scene
+	static void PlaceFoot(const FVector& FootBonePoseWorldSpaceLocation,
+		const FQuat& FootBonePoseWorldSpaceRotation,
+		const FVector& FootBonePoseComponentSpaceLocation,
+		const FIKFootPlacementParameters& FootPlacementParameters,
+		const bool PlaceFootFlag,
+		const FHitResult& FootRaycastHitResult,
+		FVector& OutTargetFootIkEffectorWorldSpaceLocation,
+		FRotator& OutTargetFootWorldSpaceRotation,
+		FVector& OutTargetFootIkPoleWorldSpaceLocation);
+
 	static void ComputePelvis(const FHitResult* const FootRaycastHitResultContiguousStorageStart,
 		const int32 NumFeet,
 		const FVector& CharacterCapsuleBottomWorldSpaceLocation,
@@ -175,4 +262,64 @@ private:
 		FRotator* const OutInterpolatedFootWorldSpaceRotationsContiguousStorageStart,
 		FVector* const OutInterpolatedFootIKPoleLocationsContiguousStorageStart,
 		FVector& OutInterpolatedPelvisBoneAdditiveWorldSpaceTranslation);
+
+private:
+	// Half height of the box swept when probing a foot's footprint
+	static constexpr float FootprintSweepHalfHeight = 1.0f;
+
+	// Performs a raycast for a foot. Returns through the input parameter the hit result of the raycast. Used as part of a character's foot IK placement system
+	static void RaycastFootForPlacement(FHitResult& OutHit,
+		const TObjectPtr<UWorld> World,
+		const FVector& FootBonePoseWorldLocation,
+		const FQuat& FootBonePoseWorldRotation,
+		const FIKFootPlacementParameters& FootPlacementParams);
+
+	// Sweeps a box covering the foot's footprint and finds the highest support under its heel half and toe half from the hits of the one sweep. When both halves are supported
+	// the contact plane is fitted through the two support points so the foot tilts between them, otherwise it is the surface plane of the one support found. On a hit, the
+	// hit location is moved onto the contact plane directly below the foot bone and the hit normal is the contact plane normal, so the result can be used in place of a
+	// raycast hit. A sweep reports one hit per shape, so a single shape under both halves, e.g. a staircase built as one mesh, only gives one support. Returns false if the
+	// only supports found were ones the footprint started inside of
+	static bool SweepFootprintForPlacement(FHitResult& OutHit,
+		const TObjectPtr<UWorld> World,
+		const FVector& FootBonePoseWorldLocation,
+		const FQuat& FootBonePoseWorldRotation,
+		const FIKFootPlacementParameters& FootPlacementParams);
+
+	// Moves a foot raycast hit from an earlier trace along the hit surface plane so it lies directly below the foot bone's current location. Lets feet be placed every update
+	// against hits that are only traced at a fixed rate
+	static void ProjectFootRaycastHitBelowFoot(FHitResult& FootRaycastHitResult, const FVector& FootBonePoseWorldLocation);
+
+	// Accumulates time and returns true when feet are due to be traced at the given rate. Always returns true when TraceRate is zero
+	static bool AdvanceFixedRateTrace(float& TraceTimeAccumulator, const float DeltaSeconds, const float TraceRate);
+
+	// Returns the foot bone location to place the foot on top of the hit geometry
+	static FVector CalculateFootPlacementLocation(const FHitResult& FootPlacementRaycastResult, const float FootBoneHeight);
+
+	// Returns the additive rotation to align the foot with the hit geometry
+	static FRotator CalculateFootPlacementAdditiveRotation(const FHitResult& FootPlacementRaycastResult,
+		const FValueConstraint& AdditivePitchConstraint,
+		const FValueConstraint& AdditiveRollConstraint);
+
+	// Returns the additive translation to add to the pelvis bone in the vertical up axis to correct pelvis location when placing feet on world collision geometry
+	static double CalculateAdditivePelvisBoneVerticalTranslationForFootPlacement(const FHitResult* const FootRaycastHitResultContiguousStorageStart,
+		const int32 NumFeet,
+		const double CapsuleBottomWorldSpaceVerticalLocation);
+
+	// Pelvis update steps shared by FPelvisFeetData and TFixedPelvisFeetData. Loops over the feet of fixed size foot data are unrolled at compile time
+
+	// Computes target foot and pelvis values for each foot attached to the pelvis from the current pose. Feet are traced when bTraceFeet is true, otherwise the hits of the
+	// last trace are moved below the posed feet
+	template<typename PelvisFeetDataType>
+	static void SolvePelvis(UWorld* const World, const FVector& CharacterCapsuleBottomWorldSpaceLocation, PelvisFeetDataType& FeetData, const bool bTraceFeet,
+		FVector& OutTargetPelvisBoneAdditiveWorldSpaceTranslation);
+
+	// Computes the target pelvis offset from the feet's raycast hits and moves feet that found no collision by the same amount
+	template<typename PelvisFeetDataType>
+	static void ComputePelvis(PelvisFeetDataType& FeetData, const FVector& CharacterCapsuleBottomWorldSpaceLocation,
+		FVector& OutTargetPelvisBoneAdditiveWorldSpaceTranslation);
+
+	// Interpolates the output towards the target values of the last solve
+	template<typename PelvisFeetDataType>
+	static void InterpolateFootPlacementValuesToOutput(const PelvisFeetDataType& FeetData, const FVector& TargetPelvisBoneAdditiveWorldSpaceTranslation,
+		const float DeltaSeconds, const float InterpolationSpeed, FFootPlacementPelvisOutput& Output);
 };
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "FunctionLibraries/CharacterAnimationLibrary.h"
+#include "FootPlacementFragments.generated.h"
+
+// Per entity foot state for crowd agents that use the foot placement system without an anim instance. Stored inline so each chunk of entities is one contiguous block of memory
+USTRUCT()
+struct FFootPlacementFeetFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	// Maximum number of feet a crowd agent can have
+	static constexpr int32 MaxFeet = 4;
+
+	FFootPlacementFeetFragment()
+	{
+		for (int32 i = 0; i < MaxFeet; ++i)
+		{
+			InterpolatedFootIKEffectorWorldLocations[i] = FVector::ZeroVector;
+			InterpolatedFootWorldRotations[i] = FRotator::ZeroRotator;
+			InterpolatedFootIKPoleWorldLocations[i] = FVector::ZeroVector;
+		}
+	}
+
+	// Transform of each foot bone relative to the entity transform after the agent has been posed. Written by the crowd's animation representation, otherwise left at the rest
+	// pose set by UFootPlacementTrait
+	FTransform PosedFootBoneLocalTransforms[MaxFeet];
+
+	// Whether each foot is currently planted. Written by the crowd's animation representation
+	bool FootPlacementFlags[MaxFeet] = {};
+
+	// Output consumed by the crowd's animation representation
+	FVector InterpolatedFootIKEffectorWorldLocations[MaxFeet];
+	FRotator InterpolatedFootWorldRotations[MaxFeet];
+	FVector InterpolatedFootIKPoleWorldLocations[MaxFeet];
+};
+
+// Per entity pelvis state for crowd agents that use the foot placement system
+USTRUCT()
+struct FFootPlacementPelvisFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	// Output consumed by the crowd's animation representation
+	FVector PelvisBoneAdditiveWorldTranslation = FVector::ZeroVector;
+};
+
+// Foot placement parameters shared by every crowd agent created from the same entity config
+USTRUCT()
+struct FFootPlacementParamsSharedFragment : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	// Filled out in the entity config's foot placement trait. Only the first FFootPlacementFeetFragment::MaxFeet feet are used
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	TArray<FIKFootPlacementParameters> IKFootPlacementFootParams = {};
+
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	float IKFootPlacementInterpSpeed = 22.5f;
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FootPlacementProcessor.h"
+#include "Mass/FootPlacementFragments.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+
+UFootPlacementProcessor::UFootPlacementProcessor()
+	:
+	EntityQuery(*this)
+{
+	ExecutionFlags = StaticCast<int32>(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+
+	// Feet are placed after agents have moved for the frame
+	ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+}
+
+void UFootPlacementProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FFootPlacementFeetFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FFootPlacementPelvisFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FFootPlacementParamsSharedFragment>();
+}
+
+void UFootPlacementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UWorld* const World = EntityManager.GetWorld();
+	const float DeltaSeconds = Context.GetDeltaTimeSeconds();
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [World, DeltaSeconds](FMassExecutionContext& Context)
+		{
+			const TConstArrayView<FTransformFragment> TransformList = Context.GetFragmentView<FTransformFragment>();
+			const TArrayView<FFootPlacementFeetFragment> FeetList = Context.GetMutableFragmentView<FFootPlacementFeetFragment>();
+			const TArrayView<FFootPlacementPelvisFragment> PelvisList = Context.GetMutableFragmentView<FFootPlacementPelvisFragment>();
+			const FFootPlacementParamsSharedFragment& FootPlacementParams = Context.GetConstSharedFragment<FFootPlacementParamsSharedFragment>();
+
+			// Every entity in a chunk shares the same foot parameters
+			const int32 NumFeet = FMath::Min(FootPlacementParams.IKFootPlacementFootParams.Num(), FFootPlacementFeetFragment::MaxFeet);
+			if (NumFeet == 0)
+			{
+				return;
+			}
+
+			// Intermediate foot placement data reused for each entity in the chunk
+			FHitResult FootRaycastHitResults[FFootPlacementFeetFragment::MaxFeet];
+			FVector TargetFootIKEffectorWorldLocations[FFootPlacementFeetFragment::MaxFeet];
+			FRotator TargetFootWorldRotations[FFootPlacementFeetFragment::MaxFeet];
+			FVector TargetFootIKPoleWorldLocations[FFootPlacementFeetFragment::MaxFeet];
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int32 EntityIndex = 0; EntityIndex < NumEntities; ++EntityIndex)
+			{
+				const FTransform& EntityTransform = TransformList[EntityIndex].GetTransform();
+				FFootPlacementFeetFragment& Feet = FeetList[EntityIndex];
+
+				// Calculate feet. The entity transform is treated as the character's component transform
+				for (int32 i = 0; i < NumFeet; ++i)
+				{
+					const FTransform PosedFootBoneWorldTransform = Feet.PosedFootBoneLocalTransforms[i] * EntityTransform;
+
+					UCharacterAnimationLibrary::ComputeFoot(World, PosedFootBoneWorldTransform.GetLocation(), PosedFootBoneWorldTransform.GetRotation(),
+						Feet.PosedFootBoneLocalTransforms[i].GetLocation(), FootPlacementParams.IKFootPlacementFootParams[i], Feet.FootPlacementFlags[i],
+						FootRaycastHitResults[i], TargetFootIKEffectorWorldLocations[i], TargetFootWorldRotations[i], TargetFootIKPoleWorldLocations[i]);
+				}
+
+				// Calculate pelvis. The entity transform is located at the bottom of the agent
+				FVector TargetPelvisBoneAdditiveWorldTranslation = FVector::ZeroVector;
+				UCharacterAnimationLibrary::ComputePelvis(FootRaycastHitResults, NumFeet, EntityTransform.GetLocation(), TargetPelvisBoneAdditiveWorldTranslation,
+					TargetFootIKEffectorWorldLocations);
+
+				// Interpolate foot placement values
+				UCharacterAnimationLibrary::InterpolateFootPlacementValues(TargetFootIKEffectorWorldLocations, TargetFootWorldRotations, TargetFootIKPoleWorldLocations,
+					TargetPelvisBoneAdditiveWorldTranslation, NumFeet, DeltaSeconds, FootPlacementParams.IKFootPlacementInterpSpeed,
+					Feet.InterpolatedFootIKEffectorWorldLocations, Feet.InterpolatedFootWorldRotations, Feet.InterpolatedFootIKPoleWorldLocations,
+					PelvisList[EntityIndex].PelvisBoneAdditiveWorldTranslation);
+			}
+		});
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "FootPlacementProcessor.generated.h"
+
+/**
+ * Runs the foot placement system for crowd agents that do not have an anim instance. Entities are processed a chunk at a time, tracing and solving the feet of each entity
+ * and writing the interpolated foot targets and pelvis offset for the crowd's animation representation
+ */
+UCLASS()
+class UFootPlacementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+private:
+	FMassEntityQuery EntityQuery;
+
+public:
+	UFootPlacementProcessor();
+
+protected:
+	void ConfigureQueries() override;
+	void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+};
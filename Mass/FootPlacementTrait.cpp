@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FootPlacementTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassCommonFragments.h"
+#include "MassEntityUtils.h"
+
+void UFootPlacementTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+	// The entity transform is used as the character's capsule bottom location
+	BuildContext.RequireFragment<FTransformFragment>();
+
+	// Initialize posed feet with the rest pose so feet are placed before the animation representation writes to them
+	FFootPlacementFeetFragment FeetFragment;
+	const int32 NumRestPoseFeet = FMath::Min(RestPoseFootBoneLocalTransforms.Num(), FFootPlacementFeetFragment::MaxFeet);
+	for (int32 i = 0; i < NumRestPoseFeet; ++i)
+	{
+		FeetFragment.PosedFootBoneLocalTransforms[i] = RestPoseFootBoneLocalTransforms[i];
+	}
+
+	BuildContext.AddFragment(FConstStructView::Make(FeetFragment));
+	BuildContext.AddFragment<FFootPlacementPelvisFragment>();
+
+	const FConstSharedStruct FootPlacementParamsFragment = EntityManager.GetOrCreateConstSharedFragment(FootPlacementParams);
+	BuildContext.AddConstSharedFragment(FootPlacementParamsFragment);
+}
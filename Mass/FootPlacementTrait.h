@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "Mass/FootPlacementFragments.h"
+#include "FootPlacementTrait.generated.h"
+
+/**
+ * Adds the foot placement system to crowd agents created from a mass entity config
+ */
+UCLASS(meta = (DisplayName = "IK Foot Placement"))
+class UFootPlacementTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	FFootPlacementParamsSharedFragment FootPlacementParams;
+
+	// Rest pose transform of each foot bone relative to the entity transform. Used until the crowd's animation representation writes posed transforms
+	UPROPERTY(EditAnywhere, Category = "IK Foot Placement")
+	TArray<FTransform> RestPoseFootBoneLocalTransforms;
+
+protected:
+	void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};